@@ -26,7 +26,8 @@
       can be swapped out to show other functionality of the setWidget function.
       After sending this command, pruss button B to cycle through pages.
     * t - set TIME: After sending this command type six numbers for HH:MM:SS
-      time should be of the 24-hour variety.
+      time should be of the 24-hour variety. The time is sent so it lands on
+      a second boundary, and resent whenever the watch may have drifted.
     * v - VIBRATE: Whoo, good vibrations.
     * l and L - BACKLIGHT: Turn the BL off or on (for a few seconds)
 	
@@ -99,7 +100,7 @@ void setup()
 void loop()
 {
   while (!Serial.available())
-    ;  // Wait for something to come in from the Serial Monitor
+    watch.maintainTime();  // Resync the watch's clock if it may have drifted
   unsigned char c = Serial.read(); // Read it into c
   switch(c)
   {
@@ -108,8 +109,13 @@ void loop()
     break;
   case 't':
     getTime(); // getTime will update the hours, minutes and seconds variables
-    // setTime updates the RTC of the MetaWatch. All 7 parameters are required.
-    watch.setTime(year, month, date, day, hours, minutes, seconds);
+    // setReferenceTime tells the library what time it is right now. All 7 parameters are required.
+    watch.setReferenceTime(year, month, date, day, hours, minutes, seconds);
+    // Ping the watch to estimate link latency, then send the time so it
+    // lands on a second boundary.
+    if (watch.measureLatency() < 0)
+      Serial.println("No response from watch, sending time uncompensated");
+    watch.syncTime();
     break;
   case 'v':
     // vibrate's three parameters are: onTime, offTime, and repeats.
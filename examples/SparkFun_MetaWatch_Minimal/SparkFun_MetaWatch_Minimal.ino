@@ -0,0 +1,52 @@
+/* SparkFun_MetaWatch Library Minimal Example
+  license: Beerware. Please use, reuse, and modify this code. If
+  you find it useful, and we meet someday, buy me a beer.
+  
+  The smallest useful MetaWatch sketch: buzz the watch whenever
+  pin 2 is pulled low.
+  
+  This sketch only needs vibrate(), so the rest of the library
+  can be left out to save flash and RAM for your own stuff. Build
+  it with these flags (or set them in SparkFun_MetaWatch_Config.h):
+  
+    -DSFE_METAWATCH_CONNECT=0 -DSFE_METAWATCH_ECHO=0
+    -DSFE_METAWATCH_TIME=0 -DSFE_METAWATCH_DISPLAY=0
+    -DSFE_METAWATCH_BACKLIGHT=0 -DSFE_METAWATCH_BATTERY=0
+    -DSFE_METAWATCH_RESET=0
+  
+  With connect() left out, the BlueSMiRF should be set up to
+  auto-connect to the watch. extras/size_report.sh compares the
+  size of this sketch with and without those flags.
+*/
+
+#include <SoftwareSerial.h>
+#include <SparkFun_MetaWatch.h>
+
+const unsigned long btBaudRate = 115200; // BlueSMiRF baud rate
+
+const int buttonPin = 2;
+
+#if SFE_METAWATCH_CONNECT
+char metaWatchAddress[] = "0018342F9B56"; // Watch BT address
+SFE_MetaWatch watch(metaWatchAddress, btBaudRate);
+#else
+// No connect(), so no need to keep the address around
+SFE_MetaWatch watch(btBaudRate);
+#endif
+
+void setup()
+{
+  pinMode(buttonPin, INPUT_PULLUP);
+  watch.begin();
+}
+
+void loop()
+{
+  if (digitalRead(buttonPin) == LOW)
+  {
+    watch.vibrate(250, 250, 2);
+    while (digitalRead(buttonPin) == LOW)
+      ; // Wait for the button to be released
+    delay(50);
+  }
+}
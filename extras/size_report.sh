@@ -0,0 +1,57 @@
+#!/usr/bin/env bash
+# size_report.sh
+#	Prints the flash and RAM used by a sketch under each library configuration
+#	(see src/SparkFun_MetaWatch_Config.h). Needs arduino-cli with the board's core installed.
+#
+#	usage: extras/size_report.sh [sketch dir] [fqbn]
+#		sketch defaults to examples/SparkFun_MetaWatch_Minimal
+#		fqbn defaults to arduino:avr:uno
+#
+#	Configurations the sketch needs a feature from won't compile, and show up as "n/a".
+
+LIB_DIR="$(cd "$(dirname "$0")/.." && pwd)"
+SKETCH="${1:-$LIB_DIR/examples/SparkFun_MetaWatch_Minimal}"
+FQBN="${2:-arduino:avr:uno}"
+
+if ! command -v arduino-cli > /dev/null; then
+	echo "arduino-cli not found. Get it from https://arduino.github.io/arduino-cli/" >&2
+	exit 1
+fi
+
+FEATURES="CONNECT ECHO TIME CLOCK_SYNC VIBRATE DISPLAY BACKLIGHT BATTERY RESET"
+
+# name|flags
+CONFIGS=("full|")
+for f in $FEATURES; do
+	flags="-DSFE_METAWATCH_$f=0"
+	# Clock sync can't be kept without setTime()
+	[ "$f" = "TIME" ] && flags="$flags -DSFE_METAWATCH_CLOCK_SYNC=0"
+	CONFIGS+=("no-$(echo "$f" | tr 'A-Z_' 'a-z-')|$flags")
+done
+minimal=""
+for f in $FEATURES; do
+	[ "$f" != "VIBRATE" ] && minimal="$minimal -DSFE_METAWATCH_$f=0"
+done
+CONFIGS+=("vibrate-only|$minimal")
+
+BUILD_ROOT="$(mktemp -d)"
+trap 'rm -rf "$BUILD_ROOT"' EXIT
+
+echo "Sketch: $(basename "$SKETCH")  Board: $FQBN"
+printf "%-16s %12s %12s\n" "config" "flash" "ram"
+for config in "${CONFIGS[@]}"; do
+	name="${config%%|*}"
+	flags="${config#*|}"
+	# Separate build path per config, so no objects are shared between them
+	out="$(arduino-cli compile --fqbn "$FQBN" --library "$LIB_DIR" \
+		--build-path "$BUILD_ROOT/$name" \
+		--build-property "compiler.cpp.extra_flags=$flags" \
+		"$SKETCH" 2>&1)"
+	if [ $? -ne 0 ]; then
+		printf "%-16s %12s %12s\n" "$name" "n/a" "n/a"
+		continue
+	fi
+	flash="$(echo "$out" | sed -n 's/^Sketch uses \([0-9]*\) bytes.*/\1/p')"
+	ram="$(echo "$out" | sed -n 's/^Global variables use \([0-9]*\) bytes.*/\1/p')"
+	printf "%-16s %12s %12s\n" "$name" "$flash" "$ram"
+done
@@ -27,12 +27,35 @@ SoftwareSerial bt(10, 11); // 10=RX, 11=TX
 SFE_MetaWatch::SFE_MetaWatch(char * addr, unsigned long baud)
 {
 	baudRate = baud;
+#if SFE_METAWATCH_CONNECT
 	for (int i=0; i<12; i++)
 	{
 		watchAddress[i] = addr[i];
 	}
+#else
+	(void)addr;	// Only connect() needs the address
+#endif
+#if SFE_METAWATCH_CLOCK_SYNC
+	linkLatency = 0;
+	timeState = 0;
+	retryPending = 0;
+#endif
 }
 
+#if !SFE_METAWATCH_CONNECT
+/* Without connect(), the address is never used, so this constructor only needs the baud.
+*/
+SFE_MetaWatch::SFE_MetaWatch(unsigned long baud)
+{
+	baudRate = baud;
+#if SFE_METAWATCH_CLOCK_SYNC
+	linkLatency = 0;
+	timeState = 0;
+	retryPending = 0;
+#endif
+}
+#endif
+
 /* begin() simply calls bt.begin() at the specified baud rate.
 	Analagous to Serial.begin(baudRate)
 */
@@ -41,6 +64,7 @@ void SFE_MetaWatch::begin()
 	bt.begin(baudRate);
 }
 
+#if SFE_METAWATCH_CONNECT
 /* connect() does its very best to initialize a connection between BlueSMiRF and MetaWatch.
 	It'll have to enter command mode (or it might already be there).
 	Then it enters the Connect command (C,address<newline>) (or it may already be connected)
@@ -108,7 +132,9 @@ int SFE_MetaWatch::connect()
 	else
 		return 1;	// Return 1 if all went according to plan
 }
+#endif
 
+#if SFE_METAWATCH_TIME
 /* setTime() sends the SET_RTC message to the MetaWatch
 	year should be the actual integer year (e.g. 2013)
 	month and date are the numbered dates (e.g. 8 and 13 respectively for August 13th)
@@ -140,7 +166,213 @@ void SFE_MetaWatch::setTime(unsigned int year, unsigned char month, unsigned cha
 
 	sendPacket(packet, nPacketBytes, 0, 0);
 }
+#endif
+
+#if SFE_METAWATCH_CLOCK_SYNC
+/* setReferenceTime() tells the library what time it is *right now*, without sending anything.
+	Parameters are the same as setTime(). The time is pinned to the current millis(), so
+	call this the moment you know the time (e.g. right after the last digit is typed in).
+	syncTime() and maintainTime() carry the reference forward from here, using millis(),
+	so the watch will only be as accurate as the Arduino's clock (see SYNC_DRIFT_PPM).
+*/
+void SFE_MetaWatch::setReferenceTime(unsigned int year, unsigned char month, unsigned char date, 
+ unsigned char weekDay, unsigned char hour, unsigned char minute, unsigned char second)
+{
+	refMillis = millis();
+	refYear = year;
+	refMonth = month;
+	refDate = date;
+	refWeekDay = weekDay;
+	refHour = hour;
+	refMinute = minute;
+	refSecond = second;
+	timeState = 1;
+	retryPending = 0;	// New time, so maintainTime() should send it right away
+}
+
+/* measureLatency() estimates the one-way latency from Arduino to watch.
+	It sends pings GET_BATTERY messages and times how long the first byte of each
+	response takes to come back. The shortest round trip is kept (longer ones just
+	picked up extra queueing delay), and half of it is our one-way latency.
+	The battery variables are updated along the way, since we got them for free
+	(if SFE_METAWATCH_BATTERY is on).
+	
+	returns:
+		the one-way latency in ms
+		-1 if none of the pings were answered
+*/
+int SFE_MetaWatch::measureLatency(unsigned char pings)
+{
+	int nPacketBytes = 6;
+	unsigned char packet[nPacketBytes];
+#if SFE_METAWATCH_BATTERY
+	unsigned char rsp[12];
+#endif
+	unsigned long best = 0xFFFFFFFF;
+	unsigned long start, rtt;
+
+	for (int p=0; p<pings; p++)
+	{
+		packet[0] = 0x01; // Start byte
+		packet[1] = nPacketBytes;
+		packet[2] = MSG_GET_BATTERY; // Get battery msg, used as a ping
+		packet[3] = 0x00; // options (not used)
+		packet[4] = 0; // CRC MSB
+		packet[5] = 0; // CRC LSB
+		
+		// Toss anything stale, so we only time our own response
+		while (bt.available())
+			bt.read();
+		
+		sendPacket(packet, nPacketBytes, 0, 0);
+		start = millis();	// SoftwareSerial writes block, so the packet is out by now
+		while (!bt.available() && (millis() - start < SYNC_PING_TIMEOUT))
+			;
+		rtt = millis() - start;
+		if (!bt.available())
+			continue;	// Lost ping, try the next one
+		if (rtt < best)
+			best = rtt;
+		
+		int i=0;
+		while ((i < 12) && (millis() - start < SYNC_PING_TIMEOUT))
+		{
+			if (bt.available())
+			{
+#if SFE_METAWATCH_BATTERY
+				rsp[i] = bt.read();
+#else
+				bt.read();	// Nowhere to keep it, just clear it out
+#endif
+				i++;
+			}
+		}
+#if SFE_METAWATCH_BATTERY
+		if (i == 12)
+			parseBattery(rsp);
+#endif
+	}
+	
+	if (best == 0xFFFFFFFF)
+		return -1;
+	
+	linkLatency = best / 2;
+	return linkLatency;
+}
+
+/* syncTime() sends the reference time (see setReferenceTime()) to the watch, timed so
+	the SET_RTC message lands right on a second boundary.
+	The send is led by the measured link latency (see measureLatency()) plus the time
+	it takes to clock the packet out at our baud rate. May block for up to a second
+	while it waits for the right moment.
+	
+	returns:
+		0 on success
+		-1 if no reference time has been set
+*/
+int SFE_MetaWatch::syncTime()
+{
+	if (timeState == 0)
+		return -1;
+	
+	// 14 byte SET_RTC packet, 10 bits per byte on the wire
+	unsigned long lead = linkLatency + (14 * 10 * 1000UL) / baudRate;
+	unsigned long elapsed = millis() - refMillis;
+	// The first whole second we can still make, counting from the reference
+	unsigned long target = ((elapsed + lead) / 1000 + 1) * 1000;
+	
+	// Move the reference up to that second. Keeps elapsed small for next time, too.
+	advanceTime(target / 1000);
+	refMillis += target;
+	
+	while ((long)(millis() - (refMillis - lead)) < 0)
+		;	// Wait for the packet to line up with the second boundary
+	setTime(refYear, refMonth, refDate, refWeekDay, refHour, refMinute, refSecond);
+	
+	lastSync = millis();
+	timeState = 2;
+	return 0;
+}
 
+/* maintainTime() is meant to be called regularly (e.g. from loop()).
+	It estimates how far the watch may have drifted since the last sync, at
+	SYNC_DRIFT_PPM, and only re-measures latency and resyncs once that estimate
+	reaches threshold (in ms). If the watch was never synced, it syncs right away.
+	If the watch doesn't answer the latency pings, it waits SYNC_RETRY_INTERVAL
+	before trying again, so an out-of-range watch doesn't stall loop() every pass.
+	
+	returns:
+		1 if the watch was resynced
+		0 if no sync was needed (or no reference time has been set, or it's backing off)
+		-1 if the latency pings went unanswered
+*/
+int SFE_MetaWatch::maintainTime(unsigned int threshold)
+{
+	if (timeState == 0)
+		return 0;
+	
+	if (retryPending && (millis() - lastAttempt < SYNC_RETRY_INTERVAL))
+		return 0;
+	
+	if (timeState == 2)
+	{
+		// Seconds first, so this doesn't overflow
+		unsigned long drift = ((millis() - lastSync) / 1000) * SYNC_DRIFT_PPM / 1000;
+		if (drift < threshold)
+			return 0;
+	}
+	
+	if (measureLatency(SYNC_PING_COUNT) < 0)
+	{
+		lastAttempt = millis();
+		retryPending = 1;
+		return -1;
+	}
+	retryPending = 0;
+	syncTime();
+	return 1;
+}
+
+/* advanceTime() moves the reference time forward by some number of seconds,
+	rolling over minutes, hours, days, months and years as it goes.
+*/
+void SFE_MetaWatch::advanceTime(unsigned long seconds)
+{
+	seconds += refSecond;
+	refSecond = seconds % 60;
+	seconds = seconds / 60 + refMinute;
+	refMinute = seconds % 60;
+	seconds = seconds / 60 + refHour;
+	refHour = seconds % 24;
+	
+	unsigned long days = seconds / 24;
+	refWeekDay = (refWeekDay + days) % 7;
+	while (days--)
+	{
+		if (++refDate > daysInMonth(refYear, refMonth))
+		{
+			refDate = 1;
+			if (++refMonth > 12)
+			{
+				refMonth = 1;
+				refYear++;
+			}
+		}
+	}
+}
+
+// Number of days in a month (1-12), accounting for leap years
+unsigned char SFE_MetaWatch::daysInMonth(unsigned int year, unsigned char month)
+{
+	if (month == 2)
+		return (((year % 4 == 0) && (year % 100 != 0)) || (year % 400 == 0)) ? 29 : 28;
+	if ((month == 4) || (month == 6) || (month == 9) || (month == 11))
+		return 30;
+	return 31;
+}
+#endif
+
+#if SFE_METAWATCH_VIBRATE
 /* vibrate() sends the SET_VIBRATE_MODE message to the MetaWatch
 	onTime is how long the vibrate motor goes for (in milliseconds)
 	offTime is the time the motor is not vibrating (milliseconds)
@@ -168,7 +400,9 @@ void SFE_MetaWatch::vibrate(unsigned int onTime, unsigned int offTime, unsigned
 	
 	sendPacket(packet, nPacketBytes, 0, 0);
 }
+#endif
 
+#if SFE_METAWATCH_DISPLAY
 /* fullscreen() tells the watch whether the Arduino will draw the full screen or just the bottom 2/3rd
 	full should be 0 or 1. If 0, the watch should draw the top 1/3 of the screen.
 		If 1, the Arduino has control over the whole thing.
@@ -216,7 +450,9 @@ void SFE_MetaWatch::update(unsigned char page, unsigned char start, unsigned cha
 	
 	sendPacket(packet, nPacketBytes, 0, 0);
 }
+#endif
 
+#if SFE_METAWATCH_BACKLIGHT
 /* setBacklight() sends the SET_BACKLIGHT (0x5D) message
 	set: 0 turns the BL off, 1 turns it on (for about 5 seconds)
 */
@@ -234,7 +470,9 @@ void SFE_MetaWatch::setBacklight(unsigned char set)
 	
 	sendPacket(packet, nPacketBytes, 0, 0);
 }
+#endif
 
+#if SFE_METAWATCH_DISPLAY
 /* setWidget() sends the Set Widget List Message (0xA1)
 	msgTotal - total messages. Unclear what exactly this should be.
 	msgIndex - Index of the message. Also unclear; related to the msgTotal variable?
@@ -291,7 +529,9 @@ void SFE_MetaWatch::clear(unsigned char black)
 	  
 	sendPacket(packet, nPacketBytes, 0, 0);
 }
+#endif
 
+#if SFE_METAWATCH_BATTERY
 /* readBattery() sends the Get Battery Status Message (0x56)
 	It'll get the response, and update these variables accordingly:
 	clipAttached - 0 or 1 that says if the charger is attached
@@ -317,12 +557,22 @@ void SFE_MetaWatch::readBattery()
 	
 	sendPacket(packet, nPacketBytes, rsp, 12);
 	
+	parseBattery(rsp);
+}
+
+/* parseBattery() pulls the battery status out of a 12-byte GET_BATTERY response.
+	Shared by readBattery() and measureLatency(), which uses the same message as a ping.
+*/
+void SFE_MetaWatch::parseBattery(unsigned char * rsp)
+{
 	clipAttached = rsp[4];
 	batteryCharging = rsp[5];
 	batteryCharge = rsp[6];
 	batteryVoltage = (rsp[9] << 8) | rsp[8];
 }
+#endif
 
+#if SFE_METAWATCH_RESET
 /* reset() tells the watch to reset()
 	Watch will reset immediately upon receipt of message.
 */
@@ -342,6 +592,7 @@ void SFE_MetaWatch::reset()
 	sendPacket(packet, nPacketBytes, 0, 0);
 	
 }
+#endif
 
 /* sendPacket() is called by just about every other member function. It calculates 
 	some CRC bytes, then sends the message string.
@@ -379,6 +630,7 @@ void SFE_MetaWatch::sendPacket(unsigned char * data, int length, unsigned char *
 	}
 }
 
+#if SFE_METAWATCH_ECHO
 /* echoMode() will set up an echo interface betwen bluetooth and the Arduino hardware serial
 	This is mostly useful if you're having trouble connecting from the BlueSMiRF to MetaWatch.
 	
@@ -414,6 +666,7 @@ void SFE_MetaWatch::echoMode()
 	}
 	Serial.println("Exiting echo mode...");
 }
+#endif
 
 /* 
 // TODO: This function needs some testing. Message not documented in API, found in source code.
@@ -478,51 +731,23 @@ void SFE_MetaWatch::idleUpdate()
 int SFE_MetaWatch::ComputeCRC(unsigned char * packet, int nBytes)
 {//CRC code taken from here:  http://zorc.breitbandkatze.de/crc.html
 
-	int i;
-	unsigned long bit, crc;
-
-
-	// at first, compute constant bit masks for whole CRC and CRC high bit
-
-	crcmask = ((((unsigned long)1<<(order-1))-1)<<1)|1;
-	crchighbit = (unsigned long)1<<(order-1);
-
-
-	// compute missing initial CRC value
-
-	if (!direct)
-	{
-		crcinit_nondirect = crcinit;
-		crc = crcinit;
-		for (i=0; i<order; i++) 
-		{
-			bit = crc & crchighbit;
-			crc<<= 1;
-			if (bit) crc^= polynom;
-		}
-		crc&= crcmask;
-		crcinit_direct = crc;
-	}
-	else 
-	{
-		crcinit_direct = crcinit;
-		crc = crcinit;
-		for (i=0; i<order; i++) 
-		{
-			bit = crc & 1;
-			if (bit) crc^= polynom;
-			crc >>= 1;
-			if (bit) crc|= crchighbit;
-		}	
-		crcinit_nondirect = crc;
-	}
-
 	int c2=crcbitbybitfast((unsigned char *)packet, nBytes);
 
 	return(c2);
 
 }
 
+// Constant bit masks for whole CRC and CRC high bit, and the initial CRC value.
+// All of these follow from the settings in the header, so they're worked out at
+// compile time rather than kept in (and recomputed into) RAM on every packet.
+// With direct = 1, crcinit already is the direct initial value. The non-direct
+// conversion isn't done here, so the typedef below refuses to compile (negative
+// array size) if direct is ever changed in the header.
+typedef char crc_direct_must_be_1[(direct == 1) ? 1 : -1];
+static const unsigned long crcmask = ((((unsigned long)1<<(order-1))-1)<<1)|1;
+static const unsigned long crchighbit = (unsigned long)1<<(order-1);
+static const unsigned long crcinit_direct = crcinit;
+
 // fast bit by bit algorithm without augmented zero bytes.
 // does not use lookup table, suited for polynom orders between 1...32.
 unsigned long SFE_MetaWatch::crcbitbybitfast(unsigned char* p, unsigned long len) 
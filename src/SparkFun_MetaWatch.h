@@ -14,6 +14,8 @@
 #ifndef SparkFun_MetaWatch_H
 #define SparkFun_MetaWatch_H
 
+#include "SparkFun_MetaWatch_Config.h"
+
 // The useful messages defined by the MetaWatch API
 // http://www.metawatch.org/assets/images/developers/MetaWatchRemoteMessageProtocol205.pdf
 #define MSG_RESET				0x07	// Reset watch
@@ -70,6 +72,18 @@
 #define BLUETOOTH_RESPONSE_DELAY 500 // TODO: Hone this value in, or better yet, find another way
 #define CONNECT_TIMEOUT 10
 
+// Clock synchronization settings, used by measureLatency(), syncTime() and maintainTime()
+#define SYNC_PING_COUNT			4	// Number of GET_BATTERY round trips per latency estimate
+#define SYNC_PING_TIMEOUT		1000	// ms to wait for a ping response before calling it lost
+#define SYNC_RETRY_INTERVAL		60000	// ms maintainTime() waits before pinging again after a failed attempt
+// Worst-case drift between the watch RTC and the reference time (parts per million).
+// The reference is carried forward by millis(), so syncing is only ever as accurate
+// as the Arduino's clock. 100 ppm assumes a crystal. Boards on a ceramic resonator
+// (like the Uno, about +/-0.5%) will drift seconds per hour; refresh the reference
+// from a better source (GPS, RTC module, host PC) with setReferenceTime() on those.
+#define SYNC_DRIFT_PPM			100
+#define SYNC_DRIFT_THRESHOLD	250	// Estimated drift (ms) that makes maintainTime() resync the watch
+
 // Varibales used for CRC calculation:
 //	This code was found in this nifty python MetaWatch emulator:
 //	https://github.com/leoluk/metawatch-simulator
@@ -90,40 +104,81 @@ private:
 	unsigned long reflect (unsigned long crc, int bitnum);
 	unsigned long crcbitbybitfast(unsigned char* p, unsigned long len);
 	int ComputeCRC(unsigned char* packet, int nBytes);
+#if SFE_METAWATCH_BATTERY
+	void parseBattery(unsigned char * rsp);
+#endif
+#if SFE_METAWATCH_CLOCK_SYNC
+	void advanceTime(unsigned long seconds);
+	unsigned char daysInMonth(unsigned int year, unsigned char month);
+#endif
 	
-	unsigned long crcmask;
-	unsigned long crchighbit;
-	unsigned long crcinit_direct;
-	unsigned long crcinit_nondirect;
-	
-	unsigned char connected;
 	unsigned long baudRate;
+#if SFE_METAWATCH_CONNECT
 	char watchAddress[12];
+#endif
+	
+#if SFE_METAWATCH_CLOCK_SYNC
+	unsigned int linkLatency;	// Estimated one-way latency to the watch (ms)
+	unsigned char timeState;	// 0 = no reference time, 1 = reference set, 2 = watch synced
+	unsigned long refMillis;	// millis() at which the reference time below was valid
+	unsigned long lastSync;		// millis() when SET_RTC was last sent
+	unsigned long lastAttempt;	// millis() of the last failed maintainTime() attempt
+	unsigned char retryPending;	// 1 if maintainTime() is backing off after a failed attempt
+	unsigned int refYear;
+	unsigned char refMonth, refDate, refWeekDay, refHour, refMinute, refSecond;
+#endif
 	
 public:
 	SFE_MetaWatch(char * addr, unsigned long baud);
+#if !SFE_METAWATCH_CONNECT
+	SFE_MetaWatch(unsigned long baud);
+#endif
 	void begin();
+#if SFE_METAWATCH_ECHO
 	void echoMode();
+#endif
+#if SFE_METAWATCH_CONNECT
 	int connect();
+#endif
+#if SFE_METAWATCH_TIME
 	void setTime(unsigned int year, unsigned char month, unsigned char date, unsigned char weekDay, unsigned char hour, unsigned char minute, unsigned char second);
+#endif
+#if SFE_METAWATCH_CLOCK_SYNC
+	void setReferenceTime(unsigned int year, unsigned char month, unsigned char date, unsigned char weekDay, unsigned char hour, unsigned char minute, unsigned char second);
+	int measureLatency(unsigned char pings=SYNC_PING_COUNT);
+	int syncTime();
+	int maintainTime(unsigned int threshold=SYNC_DRIFT_THRESHOLD);
+#endif
+#if SFE_METAWATCH_VIBRATE
 	void vibrate(unsigned int onTime, unsigned int offTime, unsigned char numCycles);
+#endif
+#if SFE_METAWATCH_DISPLAY
 	void update(unsigned char page, unsigned char start=0, unsigned char end=96, unsigned char style=1, unsigned char buffer=1, unsigned char mode=0);
 	void clear(unsigned char black);
 	void setWidget(unsigned char msgTotal, unsigned char msgIndex, unsigned char * widgIDSet, unsigned char numWidg);
 	void fullScreen(unsigned char full);
+#endif
+#if SFE_METAWATCH_BATTERY
 	void readBattery();
+#endif
+#if SFE_METAWATCH_RESET
 	void reset();
+#endif
+#if SFE_METAWATCH_BACKLIGHT
 	void setBacklight(unsigned char set);
+#endif
 	void sendPacket(unsigned char * data, int length, unsigned char * response, int responseLength);
 	
 	//void drawClockWidget(unsigned char clockId);
 	//void idleUpdate();
 	//void updateClock();
 	
+#if SFE_METAWATCH_BATTERY
 	unsigned int batteryVoltage;
 	unsigned char batteryCharge;
 	unsigned char batteryCharging;
 	unsigned char clipAttached;	
+#endif
 };
 
 #endif	// SFE_MetaWatch_H
\ No newline at end of file
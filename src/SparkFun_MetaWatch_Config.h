@@ -0,0 +1,71 @@
+/* SparkFun_MetaWatch_Config.h
+	license: Beerware. Please use, reuse, and modify this code as you see fit.
+	If you find it useful, and we meet some day, buy me a beer.
+
+	Feature selection for the SparkFun MetaWatch library.
+
+	Every feature is on by default. Setting one to 0 strips its functions,
+	and the member variables they need, out of the library. Handy on an
+	ATmega328, where every byte of RAM counts.
+
+	The library is compiled separately from your sketch, so a #define in the
+	sketch won't reach it. Either edit the defaults below, or pass them as
+	build flags (e.g. -DSFE_METAWATCH_ECHO=0) so the sketch and the library
+	both see the same values. extras/size_report.sh shows what each one costs.
+*/
+
+#ifndef SparkFun_MetaWatch_Config_H
+#define SparkFun_MetaWatch_Config_H
+
+// connect() and the 12-byte watch address copy.
+// Turn off if the BlueSMiRF is set to auto-connect to the watch.
+#ifndef SFE_METAWATCH_CONNECT
+#define SFE_METAWATCH_CONNECT	1
+#endif
+
+// echoMode() bridge between bluetooth and the hardware serial port
+#ifndef SFE_METAWATCH_ECHO
+#define SFE_METAWATCH_ECHO		1
+#endif
+
+// setTime() (SET_RTC message)
+#ifndef SFE_METAWATCH_TIME
+#define SFE_METAWATCH_TIME		1
+#endif
+
+// setReferenceTime(), measureLatency(), syncTime() and maintainTime().
+// Needs SFE_METAWATCH_TIME.
+#ifndef SFE_METAWATCH_CLOCK_SYNC
+#define SFE_METAWATCH_CLOCK_SYNC	SFE_METAWATCH_TIME
+#endif
+
+// vibrate() (SET_VIBRATE_MODE message)
+#ifndef SFE_METAWATCH_VIBRATE
+#define SFE_METAWATCH_VIBRATE	1
+#endif
+
+// update(), clear(), setWidget() and fullScreen()
+#ifndef SFE_METAWATCH_DISPLAY
+#define SFE_METAWATCH_DISPLAY	1
+#endif
+
+// setBacklight() (SET_BACKLIGHT message)
+#ifndef SFE_METAWATCH_BACKLIGHT
+#define SFE_METAWATCH_BACKLIGHT	1
+#endif
+
+// readBattery() and the battery status variables
+#ifndef SFE_METAWATCH_BATTERY
+#define SFE_METAWATCH_BATTERY	1
+#endif
+
+// reset() (RESET message)
+#ifndef SFE_METAWATCH_RESET
+#define SFE_METAWATCH_RESET		1
+#endif
+
+#if SFE_METAWATCH_CLOCK_SYNC && !SFE_METAWATCH_TIME
+#error "SFE_METAWATCH_CLOCK_SYNC needs SFE_METAWATCH_TIME"
+#endif
+
+#endif	// SparkFun_MetaWatch_Config_H